@@ -1,171 +1,2187 @@
-import sys
-from typing import List, Dict, Tuple
-from enum import Enum
-import textwrap
-import ast
-import astor
-
-class StmtType(Enum):
-    """Statement types"""
-    PRINT = 'PRINT'
-    VARIABLE = 'VARIABLE'
-    IF = 'IF'
-    ELSE = 'ELSE'
-    WHILE = 'WHILE'
-    END = 'END'
-    INPUT = 'INPUT'
-
-class ClaroError(Exception):
-    """Base error class for Claro interpreter"""
-    def __init__(self, message, line_number):
-        self.message = message
-        self.line_number = line_number
-        super().__init__(self.message)
-
-class InvalidStatementError(ClaroError):
-    """Error for invalid statements"""
-    pass
-
-class MissingArgumentError(ClaroError):
-    """Error for missing arguments"""
-    pass
-
-def parse_code(code: str) -> List[str]:
-    """Parse the code into lines"""
-    return [line.strip() for line in code.split('\n') if line.strip()]
-
-def execute_line(line: str, variables: Dict[str, str], line_number: int, output: List[str]) -> None:
-    """Execute a single line of code"""
-    print(f"Executing line {line_number}: {line}")
-    words = line.split()
-    try:
-        stmt_type = StmtType[words[0].upper()]
-    except KeyError:
-        raise InvalidStatementError(f"Invalid statement type: {words[0]}", line_number)
-
-    if stmt_type == StmtType.PRINT:
-        if len(words) < 2:
-            raise MissingArgumentError(f"PRINT statement requires an argument", line_number)
-        arg = words[1]
-        if arg.isdigit():
-            output.append(str(int(arg)))
-        else:
-            output.append(variables.get(arg, arg))
-
-    elif stmt_type == StmtType.VARIABLE:
-        if len(words) < 3:
-            raise MissingArgumentError("VARIABLE statement requires a name and a value", line_number)
-        name = words[1]
-        value = ' '.join(words[2:])
-        variables[name] = value
-
-    elif stmt_type == StmtType.IF:
-        if len(words) < 2:
-            raise MissingArgumentError("IF statement requires a condition", line_number)
-        condition = ' '.join(words[1:])
-        if eval(condition, {}, variables):
-            pass
-
-    elif stmt_type == StmtType.ELSE:
-        pass
-
-    elif stmt_type == StmtType.WHILE:
-        pass
-
-    elif stmt_type == StmtType.END:
-        pass
-
-    elif stmt_type == StmtType.INPUT:
-        if len(words) < 2:
-            raise MissingArgumentError("INPUT statement requires a variable name", line_number)
-        name = words[1]
-        variables[name] = input("Input value: ")
-
-def print_executed_code_ast(lines: List[str], variables: Dict[str, str], output: List[str]) -> None:
-    """Print the executed code and its result"""
-    print("\nExecuted Code Result:")
-    for i, line in enumerate(lines):
-        if line.startswith(('VARIABLE', 'PRINT')):
-            print(f"{i+1:03}: {line}")
-    print("\nOutput:")
-    print(f"{'':<3}{''.join(output)}")
-
-def execute_code_ast(lines: List[str]) -> Tuple[Dict[str, str], List[str]]:
-    """Execute the code"""
-    variables = {}
-    output = []
-    for i, line in enumerate(lines):
-        try:
-            execute_line(line, variables, i + 1, output)
-        except ClaroError as e:
-            print(f"Error at line {e.line_number}: {e.message}")
-        except Exception as e:
-            print(f"Error at line {i+1}: {e}")
-    return variables, output
-
-def execute_file(file_path: str) -> None:
-    with open(file_path, 'r') as file:
-        code = file.read()
-    lines = parse_code(code)
-    variables, output = execute_code_ast(lines)
-    print_executed_code_ast(lines, variables, output)
-
-def interactive_mode() -> None:
-    print("Entering interactive mode (type 'exit' to quit)")
-    variables = {}
-    output = []
-    while True:
-        try:
-            line = input("> ")
-            if line.lower() == 'exit':
-                break
-            execute_line(line, variables, 0, output)
-            print("\n".join(output))
-            output.clear()
-        except ClaroError as e:
-            print(f"Error: {e.message}")
-        except Exception as e:
-            print(f"Error: {e}")
-
-def print_help() -> None:
-    print(textwrap.dedent("""
-        Usage: claro.py [options]
-        
-        Options:
-            -e <file>      Execute the code from the specified file
-            -i             Enter interactive mode
-            -h, --help     Show this help message
-            --version      Show version information
-    """))
-
-def print_version() -> None:
-    print("Claro Interpreter Version 1.0")
-
-def main() -> None:
-    if len(sys.argv) == 1:
-        print_help()
-        sys.exit(0)
-
-    if len(sys.argv) < 2:
-        print("Error: Missing command-line arguments")
-        print_help()
-        sys.exit(1)
-
-    if sys.argv[1] == '-e':
-        if len(sys.argv) != 3:
-            print_help()
-            sys.exit(1)
-        execute_file(sys.argv[2])
-    elif sys.argv[1] == '-i':
-        interactive_mode()
-    elif sys.argv[1] == '-h' or sys.argv[1] == '--help':
-        print_help()
-    elif sys.argv[1] == '--version':
-        print_version()
-    else:
-        print("Error: Invalid option")
-        print_help()
-        sys.exit(1)
-
-if __name__ == '__main__':
-    main()
+# Keep module import time minimal: -e of a simple script should reach the
+# execute loop with nothing heavy loaded. textwrap (help text) and
+# marshal/pickle (.clarob files) are imported lazily on the code paths
+# that actually use them.
+import sys
+import os
+import json
+from array import array
+from types import CodeType
+from typing import List, Dict, Tuple
+from enum import Enum
+import ast
+
+class StmtType(Enum):
+    """Statement types"""
+    PRINT = 'PRINT'
+    VARIABLE = 'VARIABLE'
+    IF = 'IF'
+    ELSE = 'ELSE'
+    WHILE = 'WHILE'
+    END = 'END'
+    INPUT = 'INPUT'
+    IMPORT = 'IMPORT'
+    SUB = 'SUB'
+    CALL = 'CALL'
+    RETURN = 'RETURN'
+    ARRAY = 'ARRAY'
+    FILL = 'FILL'
+    MAP = 'MAP'
+    SUM = 'SUM'
+    ADD = 'ADD'
+    PARALLEL = 'PARALLEL'
+    SECTION = 'SECTION'
+    # fused superinstructions produced by the peephole pass, never written directly
+    VAR_PRINT = 'VAR_PRINT'
+    VAR_VAR = 'VAR_VAR'
+    PRINT_PRINT = 'PRINT_PRINT'
+    IF_VAR = 'IF_VAR'
+    WHILE_VAR = 'WHILE_VAR'
+
+# Superinstruction opcodes; compile_line rejects these as source statements
+FUSED_OPS = {StmtType.VAR_PRINT, StmtType.VAR_VAR, StmtType.PRINT_PRINT,
+             StmtType.IF_VAR, StmtType.WHILE_VAR}
+
+# Conditional opcodes whose runtime fault must resume at their false/exit
+# target: falling through into the body they guard would, for a WHILE,
+# loop back to the faulting condition forever
+BRANCH_OPS = {StmtType.IF, StmtType.WHILE, StmtType.IF_VAR, StmtType.WHILE_VAR}
+
+class ClaroError(Exception):
+    """Base error class for Claro interpreter"""
+    def __init__(self, message, line_number):
+        self.message = message
+        self.line_number = line_number
+        super().__init__(self.message)
+
+class InvalidStatementError(ClaroError):
+    """Error for invalid statements"""
+    pass
+
+class MissingArgumentError(ClaroError):
+    """Error for missing arguments"""
+    pass
+
+class BlockMismatchError(ClaroError):
+    """Error for IF/ELSE/WHILE blocks without a matching END"""
+    pass
+
+class InvalidExpressionError(ClaroError):
+    """Error for expressions that cannot be parsed or use disallowed constructs"""
+    pass
+
+class ModuleImportError(ClaroError):
+    """Error for IMPORT statements whose module cannot be loaded"""
+    pass
+
+class ProgramValidationError(ClaroError):
+    """Aggregate error for a program rejected by compile-time validation"""
+    def __init__(self, errors: List[ClaroError]):
+        self.errors = errors
+        super().__init__(f"{len(errors)} validation error(s)", errors[0].line_number)
+
+# Functions that expressions may call; everything else in builtins is off limits
+SAFE_FUNCTIONS = {
+    'int': int,
+    'float': float,
+    'str': str,
+    'len': len,
+    'abs': abs,
+    'min': min,
+    'max': max,
+}
+
+# Sentinel stored in a slot whose variable has not been assigned yet
+UNSET = object()
+
+class SymbolTable:
+    """Compile-time mapping of variable names to slot indexes"""
+    def __init__(self):
+        self.index: Dict[str, int] = {}
+        self.names: List[str] = []
+
+    def slot(self, name: str) -> int:
+        """Return the slot for a name, allocating one on first use"""
+        idx = self.index.get(name)
+        if idx is None:
+            idx = len(self.names)
+            self.index[name] = idx
+            self.names.append(name)
+        return idx
+
+    def __len__(self) -> int:
+        return len(self.names)
+
+class SlotRewriter(ast.NodeTransformer):
+    """Rewrite variable names in expressions into slot-indexed loads"""
+    def __init__(self, symbols: SymbolTable, skip=()):
+        self.symbols = symbols
+        self.skip = skip
+
+    def visit_Name(self, node: ast.Name):
+        if node.id in SAFE_FUNCTIONS or node.id in self.skip:
+            return node
+        return ast.copy_location(
+            ast.Subscript(ast.Name('_slots', ast.Load()),
+                          ast.Constant(self.symbols.slot(node.id)), ast.Load()),
+            node)
+
+def make_expr_globals(slots: List) -> Dict:
+    """Build the evaluation namespace shared by every expression in one run
+
+    '_calls' is the reusable call-frame stack: CALL pushes a return
+    address and RETURN pops one, with no per-call allocation.
+    """
+    return {'__builtins__': {}, **SAFE_FUNCTIONS, '_slots': slots, '_calls': []}
+
+# AST nodes an expression is allowed to contain
+ALLOWED_EXPR_NODES = (
+    ast.Expression, ast.Constant, ast.Name, ast.Load,
+    ast.BoolOp, ast.And, ast.Or,
+    ast.UnaryOp, ast.Not, ast.USub, ast.UAdd,
+    ast.BinOp, ast.Add, ast.Sub, ast.Mult, ast.Div, ast.FloorDiv, ast.Mod, ast.Pow,
+    ast.Compare, ast.Eq, ast.NotEq, ast.Lt, ast.LtE, ast.Gt, ast.GtE,
+    ast.Call,
+)
+
+def parse_expression(expr: str, line_number: int) -> ast.Expression:
+    """Parse expression text, rejecting anything outside the allowed subset"""
+    try:
+        tree = ast.parse(expr, mode='eval')
+    except SyntaxError:
+        raise InvalidExpressionError(f"Invalid expression: {expr}", line_number)
+    for node in ast.walk(tree):
+        if not isinstance(node, ALLOWED_EXPR_NODES):
+            raise InvalidExpressionError(
+                f"Disallowed construct '{type(node).__name__}' in expression: {expr}", line_number)
+        if isinstance(node, ast.Call):
+            if not isinstance(node.func, ast.Name) or node.func.id not in SAFE_FUNCTIONS:
+                raise InvalidExpressionError(
+                    f"Only calls to {', '.join(sorted(SAFE_FUNCTIONS))} are allowed: {expr}", line_number)
+            if node.keywords:
+                raise InvalidExpressionError(
+                    f"Keyword arguments are not allowed in expressions: {expr}", line_number)
+    return tree
+
+class ConstantFolder(ast.NodeTransformer):
+    """Fold constant subexpressions at compile time"""
+    def _fold(self, node):
+        try:
+            value = eval(compile(ast.fix_missing_locations(ast.Expression(node)),
+                                 '<fold>', 'eval'), {'__builtins__': {}})
+        except Exception:
+            return node
+        return ast.copy_location(ast.Constant(value), node)
+
+    def _all_constant(self, nodes):
+        return all(isinstance(node, ast.Constant) for node in nodes)
+
+    def visit_BinOp(self, node):
+        node = self.generic_visit(node)
+        if self._all_constant((node.left, node.right)):
+            return self._fold(node)
+        return node
+
+    def visit_UnaryOp(self, node):
+        node = self.generic_visit(node)
+        if isinstance(node.operand, ast.Constant):
+            return self._fold(node)
+        return node
+
+    def visit_BoolOp(self, node):
+        node = self.generic_visit(node)
+        if self._all_constant(node.values):
+            return self._fold(node)
+        return node
+
+    def visit_Compare(self, node):
+        node = self.generic_visit(node)
+        if self._all_constant([node.left] + node.comparators):
+            return self._fold(node)
+        return node
+
+def compile_expression(expr: str, line_number: int, symbols: SymbolTable):
+    """Parse, validate, and fold an expression once, returning a slot-indexed code object"""
+    tree = ConstantFolder().visit(parse_expression(expr, line_number))
+    tree = ast.fix_missing_locations(SlotRewriter(symbols).visit(tree))
+    return compile(tree, '<claro>', 'eval')
+
+def compile_map_expression(expr: str, line_number: int, symbols: SymbolTable):
+    """Compile a MAP expression over IT into a whole-array generator code object
+
+    The expression is wrapped in a generator over '_arr', so one eval in
+    the handler transforms the entire array instead of dispatching once
+    per element.
+    """
+    tree = ConstantFolder().visit(parse_expression(expr, line_number))
+    rewritten = SlotRewriter(symbols, skip=('IT',)).visit(tree)
+    gen = ast.GeneratorExp(
+        elt=rewritten.body,
+        generators=[ast.comprehension(target=ast.Name('IT', ast.Store()),
+                                      iter=ast.Name('_arr', ast.Load()),
+                                      ifs=[], is_async=0)])
+    return compile(ast.fix_missing_locations(ast.Expression(gen)), '<claro-map>', 'eval')
+
+def classify_value(text: str, line_number: int, symbols: SymbolTable):
+    """Classify PRINT/VARIABLE value text at compile time
+
+    Returns ('const', value) for text that folds to a constant,
+    ('expr', code) for an expression over already-known variables, or
+    None when the text is not an expression here (plain string data).
+    """
+    try:
+        tree = parse_expression(text, line_number)
+    except ClaroError:
+        return None
+    for node in ast.walk(tree):
+        if isinstance(node, ast.Name) and node.id not in SAFE_FUNCTIONS \
+                and node.id not in symbols.index:
+            return None
+    tree = ConstantFolder().visit(tree)
+    if isinstance(tree.body, ast.Constant):
+        return ('const', tree.body.value)
+    tree = ast.fix_missing_locations(SlotRewriter(symbols).visit(tree))
+    return ('expr', compile(tree, '<claro>', 'eval'))
+
+class Tracer:
+    """Opt-in execution tracer with sampling, per-statement filters, and JSON lines output"""
+    def __init__(self, sample: int = 1, filters=None, json_mode: bool = False, stream=None):
+        self.sample = max(1, sample)
+        self.filters = filters
+        self.json_mode = json_mode
+        self.stream = stream or sys.stderr
+        self.counter = 0
+
+    def emit(self, instr: 'Instr') -> None:
+        """Record one executed instruction, honouring filters and the sampling rate"""
+        if self.filters is not None and instr.op not in self.filters:
+            return
+        self.counter += 1
+        if self.counter % self.sample:
+            return
+        if self.json_mode:
+            self.stream.write(json.dumps({'line': instr.line_number,
+                                          'stmt': instr.op.value,
+                                          'source': instr.source}) + '\n')
+        else:
+            self.stream.write(f"Executing line {instr.line_number}: {instr.source}\n")
+
+# Global tracer; None means tracing is off and the execute loop skips it entirely
+TRACE = None
+
+class Profiler:
+    """Opt-in profiler accumulating execution counts and self-time per line and StmtType"""
+    def __init__(self):
+        self.line_stats: Dict[int, List] = {}   # line -> [count, seconds, source]
+        self.type_stats: Dict[StmtType, List] = {}  # op -> [count, seconds]
+
+    def record(self, instr: 'Instr', elapsed: float) -> None:
+        """Accumulate one instruction execution"""
+        stat = self.line_stats.get(instr.line_number)
+        if stat is None:
+            stat = self.line_stats[instr.line_number] = [0, 0.0, instr.source]
+        stat[0] += 1
+        stat[1] += elapsed
+        stat = self.type_stats.get(instr.op)
+        if stat is None:
+            stat = self.type_stats[instr.op] = [0, 0.0]
+        stat[0] += 1
+        stat[1] += elapsed
+
+    def report(self, stream) -> None:
+        """Write a hot-spot report sorted by self-time"""
+        stream.write("\nProfile (self-time per line):\n")
+        by_time = sorted(self.line_stats.items(), key=lambda item: item[1][1], reverse=True)
+        for line_number, (count, seconds, source) in by_time:
+            stream.write(f"{line_number:6}  {count:10} x  {seconds * 1000:10.3f} ms  {source}\n")
+        stream.write("\nProfile (per statement type):\n")
+        by_time = sorted(self.type_stats.items(), key=lambda item: item[1][1], reverse=True)
+        for op, (count, seconds) in by_time:
+            stream.write(f"{op.value:10}  {count:10} x  {seconds * 1000:10.3f} ms\n")
+
+    def write_folded(self, stream) -> None:
+        """Write flamegraph-compatible folded stacks (value is microseconds)"""
+        for line_number, (count, seconds, source) in sorted(self.line_stats.items()):
+            op = source.split(None, 1)[0].upper()
+            stream.write(f"claro;{op};line_{line_number} {int(seconds * 1e6)}\n")
+
+# Global profiler; None means profiling is off and the plain execute loop runs
+PROFILE = None
+
+# Magic header identifying a Claro checkpoint file
+CHECKPOINT_MAGIC = b'CLAROC\x01'
+
+class Checkpointer:
+    """Periodic snapshots of interpreter state for warm resume after a crash
+
+    tick() is called once per instruction by the checkpointed loop but
+    only touches the clock every check_every statements, so the steady
+    state costs one decrement-and-test. Snapshots flush the sink first
+    and are written atomically, so the checkpoint and the output file
+    are always consistent with each other.
+    """
+    def __init__(self, path: str, symbols: SymbolTable, interval: float = 2.0,
+                 check_every: int = 4096):
+        from time import monotonic
+        self.path = path
+        self.symbols = symbols
+        self.interval = interval
+        self.check_every = check_every
+        self.countdown = check_every
+        self.clock = monotonic
+        self.last_time = monotonic()
+
+    def tick(self, pc: int, slots: List, output: 'OutputSink', expr_globals: Dict) -> None:
+        """Snapshot if at least interval seconds passed since the last one"""
+        self.countdown -= 1
+        if self.countdown:
+            return
+        self.countdown = self.check_every
+        now = self.clock()
+        if now - self.last_time < self.interval:
+            return
+        self.last_time = now
+        self.snapshot(pc, slots, output, expr_globals)
+
+    def snapshot(self, pc: int, slots: List, output: 'OutputSink', expr_globals: Dict) -> None:
+        """Write the resumable state (pc, variable store, sink position) to disk"""
+        import pickle
+        state = {
+            'pc': pc,
+            'names': self.symbols.names,
+            'values': [None if v is UNSET else v for v in slots],
+            'unset': [v is UNSET for v in slots],
+            'output_pos': output.position(),
+            'calls': list(expr_globals['_calls']),
+        }
+        tmp = self.path + '.tmp'
+        with open(tmp, 'wb') as file:
+            file.write(CHECKPOINT_MAGIC)
+            pickle.dump(state, file, protocol=pickle.HIGHEST_PROTOCOL)
+        os.replace(tmp, self.path)
+
+def load_checkpoint(path: str) -> Dict:
+    """Read a checkpoint file back into its state dict"""
+    import pickle
+    with open(path, 'rb') as file:
+        if file.read(len(CHECKPOINT_MAGIC)) != CHECKPOINT_MAGIC:
+            raise ClaroError(f"Not a Claro checkpoint: {path}", 0)
+        return pickle.load(file)
+
+def typed_value(raw: str):
+    """Store integer-looking text as an int, everything else as an interned string"""
+    try:
+        return int(raw)
+    except ValueError:
+        return sys.intern(raw)
+
+class InputSource:
+    """Buffered source of INPUT values from a file or stdin
+
+    Prompts are only written when reading interactively from a TTY;
+    piped or file input is consumed through a large read-ahead buffer.
+    """
+    def __init__(self, stream=None, buffer_hint: int = 65536):
+        self.interactive = stream is None and sys.stdin.isatty()
+        self.stream = stream if stream is not None else sys.stdin
+        self.buffer_hint = buffer_hint
+        self.pending: List[str] = []
+        self.pos = 0
+
+    def read_line(self) -> str:
+        """Return the next input line, prompting only on a TTY"""
+        if self.interactive:
+            return input("Input value: ")
+        if self.pos >= len(self.pending):
+            self.pending = self.stream.readlines(self.buffer_hint)
+            self.pos = 0
+            if not self.pending:
+                raise EOFError("no more input")
+        line = self.pending[self.pos]
+        self.pos += 1
+        return line.rstrip('\n')
+
+    def read_record(self, count: int) -> List:
+        """Fill count values from one read; multi-value records are whitespace-split"""
+        line = self.read_line()
+        if count == 1:
+            return [typed_value(line)]
+        fields = line.split()
+        fields = fields[:count] + [''] * (count - len(fields))
+        return [typed_value(field) for field in fields]
+
+# Global input source, created on first INPUT unless --input installed one
+INPUT_SOURCE = None
+
+def get_input_source() -> InputSource:
+    """Return the active input source, defaulting to stdin"""
+    global INPUT_SOURCE
+    if INPUT_SOURCE is None:
+        INPUT_SOURCE = InputSource()
+    return INPUT_SOURCE
+
+class OutputSink:
+    """Destination for PRINT output; append() is the hot-path call"""
+    def append(self, text: str) -> None:
+        raise NotImplementedError
+
+    def flush(self) -> None:
+        pass
+
+    def close(self) -> None:
+        pass
+
+    def position(self) -> int:
+        """Resumable output position; sinks that cannot report one return 0"""
+        return 0
+
+class ListSink(OutputSink):
+    """In-memory sink matching the original accumulate-then-join behaviour"""
+    def __init__(self):
+        self.items: List[str] = []
+        self.append = self.items.append
+
+    def position(self) -> int:
+        return len(self.items)
+
+class BufferedStreamSink(OutputSink):
+    """Writes through to a stream, flushing whenever the buffer reaches flush_size characters"""
+    def __init__(self, stream, flush_size: int = 65536, close_stream: bool = False):
+        self.stream = stream
+        self.flush_size = flush_size
+        self.close_stream = close_stream
+        self.buffer: List[str] = []
+        self.buffered = 0
+
+    def append(self, text: str) -> None:
+        self.buffer.append(text)
+        self.buffered += len(text)
+        if self.buffered >= self.flush_size:
+            self.flush()
+
+    def flush(self) -> None:
+        if self.buffer:
+            self.stream.write(''.join(self.buffer))
+            self.buffer.clear()
+            self.buffered = 0
+        self.stream.flush()
+
+    def close(self) -> None:
+        self.flush()
+        if self.close_stream:
+            self.stream.close()
+
+    def position(self) -> int:
+        self.flush()
+        try:
+            return self.stream.tell()
+        except (OSError, ValueError):
+            return 0
+
+def parse_trace_options(args: List[str]) -> List[str]:
+    """Strip --trace* options from the argument list and configure the global tracer"""
+    global TRACE
+    remaining = []
+    enabled = False
+    sample = 1
+    filters = None
+    json_mode = False
+    i = 0
+    while i < len(args):
+        arg = args[i]
+        if arg == '--trace':
+            enabled = True
+        elif arg == '--trace-sample':
+            enabled = True
+            i += 1
+            sample = int(args[i])
+        elif arg == '--trace-filter':
+            enabled = True
+            i += 1
+            filters = {StmtType[name.strip().upper()] for name in args[i].split(',')}
+        elif arg == '--trace-json':
+            enabled = True
+            json_mode = True
+        else:
+            remaining.append(arg)
+        i += 1
+    if enabled:
+        TRACE = Tracer(sample, filters, json_mode)
+    return remaining
+
+class Instr:
+    """A single pre-compiled instruction (opcode plus pre-parsed operands)"""
+    __slots__ = ('op', 'args', 'line_number', 'source', 'target', 'fused_from')
+
+    def __init__(self, op: StmtType, args: tuple, line_number: int, source: str):
+        self.op = op
+        self.args = args
+        self.line_number = line_number
+        self.source = source
+        self.target = None
+        self.fused_from = None
+
+def parse_code(code: str) -> List[str]:
+    """Parse the code into lines"""
+    return [line.strip() for line in code.split('\n') if line.strip()]
+
+def compile_line(line: str, line_number: int, symbols: SymbolTable) -> Instr:
+    """Compile a single line into an instruction, validating it once up front"""
+    words = line.split()
+    try:
+        stmt_type = StmtType[words[0].upper()]
+    except KeyError:
+        raise InvalidStatementError(f"Invalid statement type: {words[0]}", line_number)
+    if stmt_type in FUSED_OPS:
+        raise InvalidStatementError(f"Invalid statement type: {words[0]}", line_number)
+
+    if stmt_type == StmtType.PRINT:
+        if len(words) < 2:
+            raise MissingArgumentError("PRINT statement requires an argument", line_number)
+        arg = words[1]
+        if len(words) == 2 and arg.isdigit():
+            # literals are classified and interned here, once, so the
+            # handler never parses or hashes anything per execution
+            args = ('lit', sys.intern(str(int(arg))))
+        elif len(words) == 2 and arg.isidentifier():
+            args = ('var', symbols.slot(arg), sys.intern(arg))
+        else:
+            value = classify_value(' '.join(words[1:]), line_number, symbols)
+            if value is None:
+                # not an expression over known variables: keep the
+                # original single-token PRINT semantics
+                args = ('var', symbols.slot(arg), sys.intern(arg))
+            elif value[0] == 'const':
+                args = ('lit', sys.intern(str(value[1])))
+            else:
+                args = value
+
+    elif stmt_type == StmtType.VARIABLE:
+        if len(words) < 3:
+            raise MissingArgumentError("VARIABLE statement requires a name and a value", line_number)
+        raw = ' '.join(words[2:])
+        if raw.startswith('='):
+            raw = raw[1:].lstrip()
+        value = classify_value(raw, line_number, symbols) if raw else None
+        if value is None:
+            value = ('const', typed_value(raw))
+        args = (symbols.slot(words[1]),) + value
+
+    elif stmt_type == StmtType.IF:
+        if len(words) < 2:
+            raise MissingArgumentError("IF statement requires a condition", line_number)
+        args = (compile_expression(' '.join(words[1:]), line_number, symbols),)
+
+    elif stmt_type == StmtType.WHILE:
+        if len(words) < 2:
+            raise MissingArgumentError("WHILE statement requires a condition", line_number)
+        args = (compile_expression(' '.join(words[1:]), line_number, symbols),)
+
+    elif stmt_type == StmtType.INPUT:
+        if len(words) < 2:
+            raise MissingArgumentError("INPUT statement requires a variable name", line_number)
+        args = tuple(symbols.slot(name) for name in words[1:])
+
+    elif stmt_type == StmtType.SUB:
+        if len(words) < 2:
+            raise MissingArgumentError("SUB statement requires a name", line_number)
+        args = (words[1],)
+
+    elif stmt_type == StmtType.CALL:
+        if len(words) < 2:
+            raise MissingArgumentError("CALL statement requires a subroutine name", line_number)
+        args = (words[1],)
+
+    elif stmt_type == StmtType.ARRAY:
+        if len(words) < 3:
+            raise MissingArgumentError("ARRAY statement requires a name and a size", line_number)
+        size = classify_value(' '.join(words[2:]), line_number, symbols)
+        if size is None:
+            raise InvalidExpressionError(f"Invalid ARRAY size: {' '.join(words[2:])}", line_number)
+        args = (symbols.slot(words[1]),) + size
+
+    elif stmt_type == StmtType.FILL:
+        if len(words) < 3:
+            raise MissingArgumentError("FILL statement requires an array name and a value", line_number)
+        value = classify_value(' '.join(words[2:]), line_number, symbols)
+        if value is None:
+            raise InvalidExpressionError(f"Invalid FILL value: {' '.join(words[2:])}", line_number)
+        args = (symbols.slot(words[1]),) + value
+
+    elif stmt_type == StmtType.MAP:
+        if len(words) < 3:
+            raise MissingArgumentError("MAP statement requires an array name and an expression", line_number)
+        args = (symbols.slot(words[1]),
+                compile_map_expression(' '.join(words[2:]), line_number, symbols))
+
+    elif stmt_type == StmtType.SUM:
+        if len(words) < 3:
+            raise MissingArgumentError("SUM statement requires an array name and a result name", line_number)
+        args = (symbols.slot(words[1]), symbols.slot(words[2]))
+
+    elif stmt_type == StmtType.ADD:
+        if len(words) < 3:
+            raise MissingArgumentError("ADD statement requires two array names", line_number)
+        args = (symbols.slot(words[1]), symbols.slot(words[2]))
+
+    elif stmt_type == StmtType.IMPORT:
+        # IMPORT is expanded by compile_into; reaching here means a
+        # context (like interactive mode) where it is not supported
+        raise InvalidStatementError("IMPORT is only available in script files", line_number)
+
+    else:
+        args = ()
+
+    return Instr(stmt_type, args, line_number, line)
+
+def resolve_blocks(program: List[Instr]) -> None:
+    """Match IF/ELSE/WHILE with their END lines and store jump targets"""
+    stack = []
+    # SECTION marker pcs collected per open PARALLEL block
+    parallel_marks: Dict[int, List[int]] = {}
+    for pc, instr in enumerate(program):
+        if instr.op in (StmtType.IF, StmtType.WHILE, StmtType.PARALLEL):
+            stack.append((pc, instr))
+        elif instr.op == StmtType.SECTION:
+            if not stack or stack[-1][1].op != StmtType.PARALLEL:
+                raise BlockMismatchError("SECTION outside of a PARALLEL block",
+                                         instr.line_number)
+            parallel_marks.setdefault(stack[-1][0], []).append(pc)
+        elif instr.op == StmtType.SUB:
+            if stack:
+                raise BlockMismatchError("SUB cannot be nested inside another block",
+                                         instr.line_number)
+            stack.append((pc, instr))
+        elif instr.op == StmtType.ELSE:
+            if not stack or stack[-1][1].op != StmtType.IF:
+                raise BlockMismatchError("ELSE without a matching IF", instr.line_number)
+            # IF jumps here (past the ELSE) when its condition is false
+            stack[-1][1].target = pc + 1
+            stack[-1] = (pc, instr)
+        elif instr.op == StmtType.END:
+            if not stack:
+                raise BlockMismatchError("END without a matching IF or WHILE", instr.line_number)
+            opener_pc, opener = stack.pop()
+            if opener.op == StmtType.WHILE:
+                # the loop condition falls out here, and END jumps back to re-test it
+                opener.target = pc + 1
+                instr.target = opener_pc
+            elif opener.op == StmtType.SUB:
+                # straight-line flow jumps over the body; the closing END
+                # becomes an implicit RETURN
+                opener.target = pc + 1
+                instr.op = StmtType.RETURN
+            elif opener.op == StmtType.PARALLEL:
+                # the handler jumps past END after merging; the section
+                # pc ranges feed resolve_parallel's disjointness check
+                opener.target = pc + 1
+                bounds = [opener_pc] + parallel_marks.pop(opener_pc, []) + [pc]
+                opener.args = (tuple((bounds[i] + 1, bounds[i + 1])
+                                     for i in range(len(bounds) - 1)),)
+            else:
+                # IF falls out here when false, ELSE skips ahead to here
+                opener.target = pc + 1
+    if stack:
+        opener = stack[-1][1]
+        raise BlockMismatchError(f"{opener.op.value} without a matching END", opener.line_number)
+
+# Parsed module lines keyed by path, invalidated when the file's mtime changes
+MODULE_CACHE: Dict[str, Tuple[float, List[str]]] = {}
+
+def load_module_lines(path: str, line_number: int) -> List[str]:
+    """Return the parsed lines of an imported module, cached by path and mtime"""
+    try:
+        mtime = os.path.getmtime(path)
+    except OSError:
+        raise ModuleImportError(f"Cannot import {path}: file not found", line_number)
+    cached = MODULE_CACHE.get(path)
+    if cached is not None and cached[0] == mtime:
+        return cached[1]
+    with open(path, 'r') as file:
+        lines = parse_code(file.read())
+    MODULE_CACHE[path] = (mtime, lines)
+    return lines
+
+def compile_into(program: List[Instr], line: str, line_number: int, symbols: SymbolTable,
+                 errors: List[ClaroError], active_imports: set) -> None:
+    """Compile one line into the program, expanding IMPORT statements inline"""
+    words = line.split(None, 1)
+    if words[0].upper() == 'IMPORT':
+        if len(words) < 2:
+            errors.append(MissingArgumentError("IMPORT statement requires a file path", line_number))
+            return
+        path = words[1].strip()
+        if path in active_imports:
+            errors.append(ModuleImportError(f"Circular import of {path}", line_number))
+            return
+        try:
+            module_lines = load_module_lines(path, line_number)
+        except ClaroError as e:
+            errors.append(e)
+            return
+        active_imports.add(path)
+        for module_line in module_lines:
+            compile_into(program, module_line, line_number, symbols, errors, active_imports)
+        active_imports.discard(path)
+        return
+    try:
+        program.append(compile_line(line, line_number, symbols))
+    except ClaroError as e:
+        errors.append(e)
+
+def compile_program(lines: List[str], symbols: SymbolTable = None,
+                    first_line: int = 1) -> Tuple[List[Instr], SymbolTable]:
+    """Compile parsed lines, rejecting the whole program if any line is malformed"""
+    program = []
+    if symbols is None:
+        symbols = SymbolTable()
+    errors = []
+    active_imports: set = set()
+    for i, line in enumerate(lines):
+        compile_into(program, line, first_line + i, symbols, errors, active_imports)
+    if not errors:
+        try:
+            resolve_blocks(program)
+            resolve_calls(program)
+            resolve_parallel(program, symbols)
+        except ClaroError as e:
+            errors.append(e)
+    if errors:
+        raise ProgramValidationError(errors)
+    fuse_program(program)
+    return program, symbols
+
+def resolve_calls(program: List[Instr]) -> None:
+    """Point every CALL at its subroutine entry and record its return address"""
+    entries = {}
+    for pc, instr in enumerate(program):
+        if instr.op == StmtType.SUB:
+            entries[instr.args[0]] = pc + 1
+    for pc, instr in enumerate(program):
+        if instr.op == StmtType.CALL:
+            name = instr.args[0]
+            if name not in entries:
+                raise InvalidStatementError(f"CALL to undefined subroutine: {name}",
+                                            instr.line_number)
+            instr.target = entries[name]
+            instr.args = (name, pc + 1)
+
+def code_slots(code: CodeType) -> set:
+    """Slot indexes a compiled expression loads
+
+    Slot loads compile to '_slots[<const>]' subscripts, so the indexes
+    are read back off the bytecode: a constant loaded immediately after
+    '_slots' is a slot number, while every other constant is program
+    data and must not be mistaken for one.
+    """
+    import dis
+    slots = set()
+    pending = False
+    for ins in dis.get_instructions(code):
+        if ins.opname in ('LOAD_GLOBAL', 'LOAD_NAME') and ins.argval == '_slots':
+            pending = True
+            continue
+        if pending and ins.opname == 'LOAD_CONST' and type(ins.argval) is int:
+            slots.add(ins.argval)
+        pending = False
+    for const in code.co_consts:
+        if isinstance(const, CodeType):
+            slots |= code_slots(const)
+    return slots
+
+def instr_reads(instr: Instr) -> set:
+    """Set of variable slots one instruction may read"""
+    op, args = instr.op, instr.args
+    if op == StmtType.PRINT:
+        if args[0] == 'var':
+            return {args[1]}
+        return code_slots(args[1]) if args[0] == 'expr' else set()
+    if op in (StmtType.VARIABLE, StmtType.ARRAY, StmtType.FILL):
+        reads = code_slots(args[2]) if args[1] == 'expr' else set()
+        if op == StmtType.FILL:
+            reads.add(args[0])
+        return reads
+    if op in (StmtType.IF, StmtType.WHILE):
+        return code_slots(args[0])
+    if op == StmtType.MAP:
+        return {args[0]} | code_slots(args[1])
+    if op in (StmtType.SUM, StmtType.ADD):
+        return set(args)
+    return set()
+
+def instr_writes(instr: Instr) -> set:
+    """Set of variable slots one instruction may write"""
+    op, args = instr.op, instr.args
+    if op in (StmtType.VARIABLE, StmtType.ARRAY, StmtType.FILL,
+              StmtType.MAP, StmtType.ADD):
+        return {args[0]}
+    if op == StmtType.SUM:
+        return {args[1]}
+    if op == StmtType.INPUT:
+        return set(args)
+    return set()
+
+# Statements that cannot appear inside a PARALLEL block: subroutines
+# and nested blocks would need cross-section control flow, and INPUT
+# would race on the shared input stream.
+PARALLEL_FORBIDDEN = {StmtType.SUB, StmtType.CALL, StmtType.INPUT, StmtType.PARALLEL}
+
+def resolve_parallel(program: List[Instr], symbols: SymbolTable) -> None:
+    """Verify PARALLEL sections touch disjoint slots and attach their payloads
+
+    Sections may read shared variables, but a variable written by one
+    section must not be read or written by any other. Each PARALLEL
+    instruction ends up carrying its sections as source lines plus
+    written-slot sets (for recompile-in-worker execution and the
+    ordered merge back into the parent store) and a snapshot of the
+    symbol names so workers reproduce the same slot numbering.
+    """
+    for instr in program:
+        if instr.op is not StmtType.PARALLEL:
+            continue
+        sections = []
+        reads = []
+        writes = []
+        for start, end in instr.args[0]:
+            if end <= start:
+                # a SECTION opening the block leaves an empty leading range
+                continue
+            section_reads = set()
+            section_writes = set()
+            for member in program[start:end]:
+                if member.op in PARALLEL_FORBIDDEN:
+                    raise InvalidStatementError(
+                        f"{member.op.value} is not allowed inside PARALLEL",
+                        member.line_number)
+                section_reads |= instr_reads(member)
+                section_writes |= instr_writes(member)
+            lines = tuple(member.source for member in program[start:end])
+            first_line = program[start].line_number if end > start else instr.line_number
+            sections.append((lines, first_line, tuple(sorted(section_writes))))
+            reads.append(section_reads)
+            writes.append(section_writes)
+        for i in range(len(sections)):
+            for j in range(len(sections)):
+                if i == j:
+                    continue
+                overlap = writes[i] & (reads[j] | writes[j])
+                if overlap:
+                    shared = ', '.join(sorted(
+                        symbols.names[s] if s < len(symbols.names) else str(s)
+                        for s in overlap))
+                    raise InvalidStatementError(
+                        f"PARALLEL sections must touch disjoint variables (shared: {shared})",
+                        instr.line_number)
+        instr.args = (tuple(sections), tuple(symbols.names))
+
+def fuse_program(program: List[Instr]) -> None:
+    """Peephole pass collapsing common statement sequences into superinstructions
+
+    The fused instruction replaces the first instruction of the pattern
+    and jumps past its components, which stay in place untouched — so
+    any jump landing inside the pattern still executes the original
+    sequence and no targets need rewriting.
+    """
+    i = 0
+    n = len(program)
+    while i < n:
+        instr = program[i]
+        fused = None
+        consumed = 1
+
+        if instr.op == StmtType.VARIABLE and i + 1 < n:
+            nxt = program[i + 1]
+            if nxt.op == StmtType.PRINT:
+                fused = Instr(StmtType.VAR_PRINT, (instr.args, nxt.args),
+                              instr.line_number, instr.source)
+                consumed = 2
+            elif nxt.op == StmtType.VARIABLE:
+                fused = Instr(StmtType.VAR_VAR, (instr.args, nxt.args),
+                              instr.line_number, instr.source)
+                consumed = 2
+
+        elif instr.op == StmtType.PRINT and i + 1 < n \
+                and program[i + 1].op == StmtType.PRINT:
+            fused = Instr(StmtType.PRINT_PRINT, (instr.args, program[i + 1].args),
+                          instr.line_number, instr.source)
+            consumed = 2
+
+        elif instr.op in (StmtType.WHILE, StmtType.IF) and i + 2 < n \
+                and instr.target == i + 3:
+            body, end = program[i + 1], program[i + 2]
+            if body.op == StmtType.VARIABLE and end.op == StmtType.END:
+                if instr.op == StmtType.WHILE and end.target == i:
+                    # the whole increment-test loop runs inside one handler
+                    fused = Instr(StmtType.WHILE_VAR, (instr.args[0], body.args),
+                                  instr.line_number, instr.source)
+                    consumed = 3
+                elif instr.op == StmtType.IF and end.target is None:
+                    fused = Instr(StmtType.IF_VAR, (instr.args[0], body.args),
+                                  instr.line_number, instr.source)
+                    consumed = 3
+
+        if fused is not None:
+            fused.target = i + consumed
+            fused.fused_from = instr
+            program[i] = fused
+        i += consumed
+
+# Statement handlers share one signature: (instr, slots, output, expr_globals)
+# and return a jump target or None to fall through.
+
+def op_print(instr: Instr, slots: List, output: OutputSink, expr_globals: Dict):
+    kind = instr.args[0]
+    if kind == 'lit':
+        output.append(instr.args[1])
+    elif kind == 'var':
+        value = slots[instr.args[1]]
+        if value is UNSET:
+            output.append(instr.args[2])
+        elif value.__class__ is array:
+            output.append(' '.join(map(str, value)))
+        else:
+            output.append(str(value))
+    else:
+        output.append(str(eval(instr.args[1], expr_globals)))
+    return None
+
+def op_variable(instr: Instr, slots: List, output: OutputSink, expr_globals: Dict):
+    slot, kind, payload = instr.args
+    slots[slot] = payload if kind == 'const' else eval(payload, expr_globals)
+    return None
+
+def op_if(instr: Instr, slots: List, output: OutputSink, expr_globals: Dict):
+    if not eval(instr.args[0], expr_globals):
+        return instr.target
+    return None
+
+def op_else(instr: Instr, slots: List, output: OutputSink, expr_globals: Dict):
+    # only reached after the true branch ran, so skip past the END
+    return instr.target
+
+def op_while(instr: Instr, slots: List, output: OutputSink, expr_globals: Dict):
+    if not eval(instr.args[0], expr_globals):
+        return instr.target
+    return None
+
+def op_end(instr: Instr, slots: List, output: OutputSink, expr_globals: Dict):
+    # jumps back to its WHILE, or falls through for an IF block
+    return instr.target
+
+def op_input(instr: Instr, slots: List, output: OutputSink, expr_globals: Dict):
+    values = get_input_source().read_record(len(instr.args))
+    for slot, value in zip(instr.args, values):
+        slots[slot] = value
+    return None
+
+def op_sub(instr: Instr, slots: List, output: OutputSink, expr_globals: Dict):
+    # straight-line flow skips over the subroutine body
+    return instr.target
+
+def op_call(instr: Instr, slots: List, output: OutputSink, expr_globals: Dict):
+    expr_globals['_calls'].append(instr.args[1])
+    return instr.target
+
+def op_return(instr: Instr, slots: List, output: OutputSink, expr_globals: Dict):
+    calls = expr_globals['_calls']
+    if not calls:
+        raise ClaroError("RETURN outside of a CALL", instr.line_number)
+    return calls.pop()
+
+def run_parallel_section(payload) -> tuple:
+    """Recompile and run one PARALLEL section in a worker process
+
+    Slot values travel as (values, unset) pairs because the UNSET
+    sentinel loses its identity across process boundaries.
+    """
+    lines, first_line, names, values, unset = payload
+    symbols = SymbolTable()
+    for name in names:
+        symbols.slot(name)
+    program, _ = compile_program(list(lines), symbols, first_line)
+    slots = [UNSET if u else v for v, u in zip(values, unset)]
+    while len(slots) < len(symbols):
+        slots.append(UNSET)
+    sink = ListSink()
+    errors: List[Dict] = []
+    run_instrs(program, slots, sink, make_expr_globals(slots), errors)
+    return ([None if v is UNSET else v for v in slots],
+            [v is UNSET for v in slots], sink.items, errors)
+
+def op_parallel(instr: Instr, slots: List, output: OutputSink, expr_globals: Dict):
+    sections, names = instr.args
+    if len(sections) < 2 or (os.cpu_count() or 1) < 2:
+        # a single section (or a single core) gains nothing from
+        # workers; fall through and run the sections in place
+        return None
+    values = [None if v is UNSET else v for v in slots]
+    unset = [v is UNSET for v in slots]
+    payloads = [(lines, first_line, names, values, unset)
+                for lines, first_line, touched in sections]
+    try:
+        from multiprocessing import Pool
+        with Pool(min(len(sections), os.cpu_count() or 1)) as pool:
+            results = pool.map(run_parallel_section, payloads)
+    except Exception:
+        # workers unavailable: fall through to in-place serial execution
+        return None
+    # ordered merge: each section contributes only its own (disjoint)
+    # touched slots, and outputs land in section order
+    for (r_values, r_unset, items, errors), (lines, first_line, touched) \
+            in zip(results, sections):
+        for slot in touched:
+            if slot < len(slots) and slot < len(r_values):
+                slots[slot] = UNSET if r_unset[slot] else r_values[slot]
+        for item in items:
+            output.append(item)
+        collected = expr_globals.get('_errors')
+        if collected is not None:
+            collected.extend(errors)
+        else:
+            for error in errors:
+                print(f"Error at line {error['line']}: {error['error']}")
+    return instr.target
+
+def op_section(instr: Instr, slots: List, output: OutputSink, expr_globals: Dict):
+    # only reached on the serial fallback path; a pure boundary marker
+    return None
+
+def build_array(values) -> array:
+    """Pack computed values into a compact typed buffer ('q' for ints, 'd' for floats)"""
+    values = list(values)
+    try:
+        return array('q', values)
+    except (TypeError, OverflowError):
+        return array('d', values)
+
+def op_array(instr: Instr, slots: List, output: OutputSink, expr_globals: Dict):
+    slot, kind, payload = instr.args
+    size = payload if kind == 'const' else eval(payload, expr_globals)
+    # zero-filled int64 buffer, allocated in one step
+    slots[slot] = array('q', bytes(8 * int(size)))
+    return None
+
+def op_fill(instr: Instr, slots: List, output: OutputSink, expr_globals: Dict):
+    slot, kind, payload = instr.args
+    value = payload if kind == 'const' else eval(payload, expr_globals)
+    # array repetition runs in C: one dispatch fills the whole buffer
+    slots[slot] = build_array((value,)) * len(slots[slot])
+    return None
+
+def op_map(instr: Instr, slots: List, output: OutputSink, expr_globals: Dict):
+    slot, code = instr.args
+    expr_globals['_arr'] = slots[slot]
+    slots[slot] = build_array(eval(code, expr_globals))
+    return None
+
+def op_sum(instr: Instr, slots: List, output: OutputSink, expr_globals: Dict):
+    src, dest = instr.args
+    slots[dest] = sum(slots[src])
+    return None
+
+def op_add(instr: Instr, slots: List, output: OutputSink, expr_globals: Dict):
+    dest, other = instr.args
+    slots[dest] = build_array(x + y for x, y in zip(slots[dest], slots[other]))
+    return None
+
+def store_variable(slots: List, args: tuple, expr_globals: Dict) -> None:
+    """Shared VARIABLE assignment used by the fused handlers"""
+    slot, kind, payload = args
+    slots[slot] = payload if kind == 'const' else eval(payload, expr_globals)
+
+def append_print(slots: List, output: OutputSink, args: tuple, expr_globals: Dict) -> None:
+    """Shared PRINT append used by the fused handlers"""
+    kind = args[0]
+    if kind == 'lit':
+        output.append(args[1])
+    elif kind == 'var':
+        value = slots[args[1]]
+        if value is UNSET:
+            output.append(args[2])
+        elif value.__class__ is array:
+            output.append(' '.join(map(str, value)))
+        else:
+            output.append(str(value))
+    else:
+        output.append(str(eval(args[1], expr_globals)))
+
+def op_var_print(instr: Instr, slots: List, output: OutputSink, expr_globals: Dict):
+    var_args, print_args = instr.args
+    store_variable(slots, var_args, expr_globals)
+    append_print(slots, output, print_args, expr_globals)
+    return instr.target
+
+def op_var_var(instr: Instr, slots: List, output: OutputSink, expr_globals: Dict):
+    first, second = instr.args
+    store_variable(slots, first, expr_globals)
+    store_variable(slots, second, expr_globals)
+    return instr.target
+
+def op_print_print(instr: Instr, slots: List, output: OutputSink, expr_globals: Dict):
+    first, second = instr.args
+    append_print(slots, output, first, expr_globals)
+    append_print(slots, output, second, expr_globals)
+    return instr.target
+
+def op_if_var(instr: Instr, slots: List, output: OutputSink, expr_globals: Dict):
+    condition, var_args = instr.args
+    if eval(condition, expr_globals):
+        store_variable(slots, var_args, expr_globals)
+    return instr.target
+
+def op_while_var(instr: Instr, slots: List, output: OutputSink, expr_globals: Dict):
+    condition, (slot, kind, payload) = instr.args
+    if kind == 'const':
+        while eval(condition, expr_globals):
+            slots[slot] = payload
+    else:
+        while eval(condition, expr_globals):
+            slots[slot] = eval(payload, expr_globals)
+    return instr.target
+
+# O(1) opcode dispatch table; new statements register here instead of
+# growing an if/elif ladder in the execute loop
+HANDLERS = {
+    StmtType.PRINT: op_print,
+    StmtType.VARIABLE: op_variable,
+    StmtType.IF: op_if,
+    StmtType.ELSE: op_else,
+    StmtType.WHILE: op_while,
+    StmtType.END: op_end,
+    StmtType.INPUT: op_input,
+    StmtType.SUB: op_sub,
+    StmtType.CALL: op_call,
+    StmtType.RETURN: op_return,
+    StmtType.ARRAY: op_array,
+    StmtType.FILL: op_fill,
+    StmtType.MAP: op_map,
+    StmtType.SUM: op_sum,
+    StmtType.ADD: op_add,
+    StmtType.PARALLEL: op_parallel,
+    StmtType.SECTION: op_section,
+    StmtType.VAR_PRINT: op_var_print,
+    StmtType.VAR_VAR: op_var_var,
+    StmtType.PRINT_PRINT: op_print_print,
+    StmtType.IF_VAR: op_if_var,
+    StmtType.WHILE_VAR: op_while_var,
+}
+
+def execute_instr(instr: Instr, slots: List, output: OutputSink, expr_globals: Dict):
+    """Execute a single pre-compiled instruction, returning a jump target or None to fall through"""
+    return HANDLERS[instr.op](instr, slots, output, expr_globals)
+
+def execute_line(line: str, symbols: SymbolTable, slots: List, line_number: int,
+                 output: OutputSink, expr_globals: Dict) -> None:
+    """Compile and execute a single line of code"""
+    instr = compile_line(line, line_number, symbols)
+    while len(slots) < len(symbols):
+        slots.append(UNSET)
+    if TRACE is not None:
+        TRACE.emit(instr)
+    execute_instr(instr, slots, output, expr_globals)
+
+# Statement types the transpiler knows how to translate
+TRANSPILABLE_OPS = {StmtType.PRINT, StmtType.VARIABLE, StmtType.IF,
+                    StmtType.ELSE, StmtType.WHILE, StmtType.END}
+
+def stamped(node: ast.AST, line: int) -> ast.AST:
+    """Stamp a transpiled node tree with its Claro source line
+
+    Bytecode positions come from the expression nodes, so every node is
+    stamped; a runtime fault in the transpiled program then reports the
+    Claro line, not a line of generated Python.
+    """
+    for child in ast.walk(node):
+        if 'lineno' in child._attributes:
+            child.lineno = child.end_lineno = line
+            child.col_offset = child.end_col_offset = 0
+    return node
+
+def condition_ast(instr: Instr) -> ast.expr:
+    """Re-parse an already-validated IF/WHILE condition into an expression node"""
+    return stamped(ast.parse(instr.source.split(None, 1)[1], mode='eval').body,
+                   instr.line_number)
+
+def transpile_block(program: List[Instr], pc: int, symbols: SymbolTable) -> Tuple[List[ast.stmt], int]:
+    """Translate instructions into Python statements until an ELSE/END or the program end"""
+    stmts = []
+    while pc < len(program):
+        instr = program[pc]
+        if instr.fused_from is not None:
+            # transpile the original sequence; its components are still in place
+            instr = instr.fused_from
+
+        if instr.op in (StmtType.ELSE, StmtType.END):
+            return stmts, pc
+
+        if instr.op == StmtType.PRINT:
+            if instr.args[0] == 'lit':
+                arg = ast.Constant(instr.args[1])
+            elif instr.args[0] == 'var':
+                name = instr.args[2]
+                arg = ast.Call(ast.Name('str', ast.Load()),
+                               [ast.Call(ast.Attribute(ast.Name('_claro_vars', ast.Load()), 'get', ast.Load()),
+                                         [ast.Constant(name), ast.Constant(name)], [])], [])
+            else:
+                expr = ast.parse(instr.source.split(None, 1)[1], mode='eval').body
+                arg = ast.Call(ast.Name('str', ast.Load()), [expr], [])
+            stmts.append(stamped(ast.Expr(ast.Call(
+                ast.Attribute(ast.Name('_claro_output', ast.Load()), 'append', ast.Load()),
+                [arg], [])), instr.line_number))
+            pc += 1
+
+        elif instr.op == StmtType.VARIABLE:
+            slot, kind, payload = instr.args
+            if kind == 'const':
+                value = ast.Constant(payload)
+            else:
+                text = instr.source.split(None, 2)[2]
+                if text.startswith('='):
+                    text = text[1:].lstrip()
+                value = ast.parse(text, mode='eval').body
+            stmts.append(stamped(ast.Assign([ast.Name(symbols.names[slot], ast.Store())],
+                                            value), instr.line_number))
+            pc += 1
+
+        elif instr.op == StmtType.IF:
+            body, pc = transpile_block(program, pc + 1, symbols)
+            orelse = []
+            if pc < len(program) and program[pc].op == StmtType.ELSE:
+                orelse, pc = transpile_block(program, pc + 1, symbols)
+            stmts.append(ast.If(condition_ast(instr), body or [ast.Pass()], orelse))
+            pc += 1  # skip the END
+
+        elif instr.op == StmtType.WHILE:
+            body, pc = transpile_block(program, pc + 1, symbols)
+            stmts.append(ast.While(condition_ast(instr), body or [ast.Pass()], []))
+            pc += 1  # skip the END
+
+    return stmts, pc
+
+def transpile_program(program: List[Instr], symbols: SymbolTable):
+    """Translate a compiled program into one Python code object, or None if unsupported"""
+    if any((instr.fused_from or instr).op not in TRANSPILABLE_OPS for instr in program):
+        return None
+    stmts, _ = transpile_block(program, 0, symbols)
+    module = ast.fix_missing_locations(ast.Module(body=stmts, type_ignores=[]))
+    # compiled straight from the AST: the stamped Claro line numbers are
+    # what maps a runtime fault back to its source statement
+    return compile(module, '<claro-jit>', 'exec')
+
+def execute_code_jit(lines: List[str], sink: OutputSink = None) -> Tuple[List, OutputSink]:
+    """Transpile the code to native Python and run it, falling back to the interpreter"""
+    program, symbols = compile_program(lines)
+    return run_program_jit(program, symbols, sink)
+
+def jit_fault_line(e: Exception) -> int:
+    """Claro line of the deepest transpiled frame in an exception, or None"""
+    tb = e.__traceback__
+    line = None
+    while tb is not None:
+        if tb.tb_frame.f_code.co_filename == '<claro-jit>':
+            line = tb.tb_lineno
+        tb = tb.tb_next
+    return line
+
+def run_program_jit(program: List[Instr], symbols: SymbolTable, sink: OutputSink = None,
+                    errors: List[Dict] = None) -> Tuple[List, OutputSink]:
+    """Run a compiled program through the transpiler, falling back to the interpreter
+
+    A runtime fault is reported in the interpreter's format and
+    execution resumes in the interpreter from after the faulting
+    statement (or a faulting condition's false branch), so both
+    backends agree on error behavior.
+    """
+    code = transpile_program(program, symbols)
+    if code is None:
+        return run_program(program, symbols, sink, errors)
+    variables = {}
+    output = sink if sink is not None else ListSink()
+    exec_globals = {'__builtins__': {}, **SAFE_FUNCTIONS,
+                    '_claro_output': output, '_claro_vars': variables}
+    try:
+        exec(code, exec_globals, variables)
+    except Exception as e:
+        line = jit_fault_line(e)
+        pc = next((i for i, instr in enumerate(program)
+                   if (instr.fused_from or instr).line_number == line), None)
+        if pc is None:
+            if errors is not None:
+                errors.append({'error': str(e)})
+            else:
+                print(f"Error: {e}")
+        else:
+            instr = program[pc].fused_from or program[pc]
+            if errors is not None:
+                errors.append({'line': line, 'stmt': instr.op.value, 'error': str(e)})
+            else:
+                print(f"Error at line {line}: {e}")
+            slots = [variables.get(name, UNSET) for name in symbols.names]
+            resume = instr.target if instr.op in BRANCH_OPS and instr.target is not None \
+                else pc + 1
+            run_instrs(program, slots, output, make_expr_globals(slots), errors,
+                       start_pc=resume)
+            return slots, output
+    return [variables.get(name, UNSET) for name in symbols.names], output
+
+# Magic header identifying a compiled Claro program file
+CLAROB_MAGIC = b'CLAROB\x01'
+
+def clarob_path(file_path: str) -> str:
+    """Return the compiled-program path that sits next to a source file"""
+    return file_path + 'b' if file_path.endswith('.claro') else file_path + '.clarob'
+
+def freeze_arg(arg):
+    """Make one instruction operand serializable (code objects go through marshal)"""
+    import marshal
+    return ('__code__', marshal.dumps(arg)) if isinstance(arg, CodeType) else arg
+
+def thaw_arg(arg):
+    """Reverse freeze_arg"""
+    import marshal
+    return marshal.loads(arg[1]) if isinstance(arg, tuple) and arg[0] == '__code__' else arg
+
+def save_program(path: str, program: List[Instr], symbols: SymbolTable) -> None:
+    """Serialize a compiled program and its symbol table to a .clarob file"""
+    import pickle
+    # serialize the unfused form; fusion is deterministic and reapplied on load
+    unfused = [instr.fused_from or instr for instr in program]
+    data = {
+        'names': symbols.names,
+        'instrs': [(instr.op.value, tuple(freeze_arg(arg) for arg in instr.args),
+                    instr.line_number, instr.source, instr.target) for instr in unfused],
+    }
+    with open(path, 'wb') as file:
+        file.write(CLAROB_MAGIC)
+        pickle.dump(data, file, protocol=pickle.HIGHEST_PROTOCOL)
+
+def load_program(path: str) -> Tuple[List[Instr], SymbolTable]:
+    """Deserialize a .clarob file back into a ready-to-run program"""
+    import pickle
+    with open(path, 'rb') as file:
+        if file.read(len(CLAROB_MAGIC)) != CLAROB_MAGIC:
+            raise ClaroError(f"Not a compiled Claro program: {path}", 0)
+        data = pickle.load(file)
+    symbols = SymbolTable()
+    for name in data['names']:
+        symbols.slot(name)
+    program = []
+    for op, args, line_number, source, target in data['instrs']:
+        instr = Instr(StmtType[op], tuple(thaw_arg(arg) for arg in args), line_number, source)
+        instr.target = target
+        program.append(instr)
+    fuse_program(program)
+    return program, symbols
+
+def revert_instr(instr: Instr) -> Instr:
+    """Return a pristine, unresolved copy of a cached instruction
+
+    Jump targets are recomputed by resolve_blocks/resolve_calls over the
+    merged program, and an END that became an implicit RETURN is turned
+    back so the block passes see what compile_line produced.
+    """
+    op = instr.op
+    if op == StmtType.RETURN and instr.source.split(None, 1)[0].upper() == 'END':
+        op = StmtType.END
+    return Instr(op, instr.args, instr.line_number, instr.source)
+
+def compile_program_incremental(lines: List[str], cached_program: List[Instr],
+                                symbols: SymbolTable) -> Tuple[List[Instr], SymbolTable]:
+    """Recompile a changed file, reusing the longest unchanged line prefix
+
+    Instructions whose source line matches the cached program are reused
+    as-is — skipping the expression parse, validation, and folding that
+    dominate compile time — and only the edited suffix goes through
+    compile_line. The symbol table is seeded from the cached run so the
+    reused slot numbering stays valid; resolve/fuse are linear passes
+    and are simply re-run over the whole merged program.
+    """
+    unfused = [instr.fused_from or instr for instr in cached_program]
+    program = []
+    reused = 0
+    while reused < len(lines) and reused < len(unfused) \
+            and unfused[reused].source == lines[reused]:
+        program.append(revert_instr(unfused[reused]))
+        reused += 1
+    errors: List[ClaroError] = []
+    active_imports: set = set()
+    for i in range(reused, len(lines)):
+        compile_into(program, lines[i], i + 1, symbols, errors, active_imports)
+    if not errors:
+        try:
+            resolve_blocks(program)
+            resolve_calls(program)
+            resolve_parallel(program, symbols)
+        except ClaroError as e:
+            errors.append(e)
+    if errors:
+        raise ProgramValidationError(errors)
+    fuse_program(program)
+    return program, symbols
+
+def compile_file(file_path: str) -> None:
+    """Compile a source file and write the result next to it as a .clarob file"""
+    with open(file_path, 'r') as file:
+        code = file.read()
+    try:
+        program, symbols = compile_program(parse_code(code))
+    except ProgramValidationError as e:
+        report_validation_errors(e)
+        sys.exit(1)
+    out_path = clarob_path(file_path)
+    save_program(out_path, program, symbols)
+    print(f"Compiled {file_path} -> {out_path}")
+
+def load_or_compile_file(file_path: str) -> Tuple[List[Instr], SymbolTable]:
+    """Load a program, reusing a fresh .clarob beside the source when one exists
+
+    A stale .clarob is not discarded: the changed file is recompiled
+    incrementally against it and the cache is refreshed, so small edits
+    to large scripts only pay for the lines after the edit.
+    """
+    if file_path.endswith('.clarob'):
+        return load_program(file_path)
+    cached = clarob_path(file_path)
+    if os.path.exists(cached):
+        if os.path.getmtime(cached) >= os.path.getmtime(file_path):
+            return load_program(cached)
+        try:
+            cached_program, cached_symbols = load_program(cached)
+        except Exception:
+            cached_program = None
+        if cached_program is not None:
+            with open(file_path, 'r') as file:
+                lines = parse_code(file.read())
+            program, symbols = compile_program_incremental(lines, cached_program,
+                                                           cached_symbols)
+            save_program(cached, program, symbols)
+            return program, symbols
+    with open(file_path, 'r') as file:
+        code = file.read()
+    return compile_program(parse_code(code))
+
+class Program:
+    """Immutable compiled form of one script, shareable across executions
+
+    Holds only read-only compile products — the instruction list with
+    its precomputed jump targets and code objects, plus the symbol
+    table — and is never mutated by execution, so N concurrent runs of
+    one script cost a single copy of the program and one thin
+    ExecutionContext each.
+    """
+    __slots__ = ('instrs', 'symbols')
+
+    def __init__(self, instrs: List[Instr], symbols: SymbolTable):
+        self.instrs = instrs
+        self.symbols = symbols
+
+class ExecutionContext:
+    """Per-execution mutable state: the slot store, sink, and expression namespace"""
+    __slots__ = ('slots', 'sink', 'expr_globals', 'errors')
+
+    def __init__(self, program: Program, sink: OutputSink = None,
+                 errors: List[Dict] = None):
+        self.slots = [UNSET] * len(program.symbols)
+        self.sink = sink if sink is not None else ListSink()
+        self.expr_globals = make_expr_globals(self.slots)
+        self.errors = errors
+
+# Shared compiled programs keyed by path, invalidated when the file's
+# mtime changes; every concurrent execution of a script reuses the one
+# cached copy
+PROGRAM_CACHE: Dict[str, Tuple[float, Program]] = {}
+
+def shared_program(path: str) -> Program:
+    """Return the single shared compiled Program for a script path"""
+    mtime = os.path.getmtime(path)
+    cached = PROGRAM_CACHE.get(path)
+    if cached is not None and cached[0] == mtime:
+        return cached[1]
+    instrs, symbols = load_or_compile_file(path)
+    program = Program(instrs, symbols)
+    PROGRAM_CACHE[path] = (mtime, program)
+    return program
+
+def run_context(program: Program, context: ExecutionContext) -> None:
+    """Execute one context against a shared program"""
+    run_instrs(program.instrs, context.slots, context.sink,
+               context.expr_globals, context.errors)
+
+def execute_code_ast(lines: List[str], sink: OutputSink = None) -> Tuple[List, OutputSink]:
+    """Compile the code once, then execute the instruction list"""
+    program, symbols = compile_program(lines)
+    return run_program(program, symbols, sink)
+
+def run_program(program: List[Instr], symbols: SymbolTable, sink: OutputSink = None,
+                errors: List[Dict] = None, checkpoint: Checkpointer = None,
+                resume_state: Dict = None, stats: Dict = None) -> Tuple[List, OutputSink]:
+    """Run a compiled program with fresh state through the program-counter loop
+
+    Pass an errors list to collect faults as structured records instead
+    of printing them. A Checkpointer makes the run resumable; a resume
+    state restores the variable store and continues from its pc.
+    """
+    slots = [UNSET] * len(symbols)
+    output = sink if sink is not None else ListSink()
+    expr_globals = make_expr_globals(slots)
+    start_pc = 0
+    if resume_state is not None:
+        for name, value, unset in zip(resume_state['names'], resume_state['values'],
+                                      resume_state['unset']):
+            idx = symbols.index.get(name)
+            if idx is not None and not unset:
+                slots[idx] = value
+        expr_globals['_calls'].extend(resume_state['calls'])
+        start_pc = resume_state['pc']
+    run_instrs(program, slots, output, expr_globals, errors, checkpoint, start_pc, stats)
+    return slots, output
+
+def run_instrs(program: List[Instr], slots: List, output: OutputSink,
+               expr_globals: Dict, errors: List[Dict] = None,
+               checkpoint: Checkpointer = None, start_pc: int = 0,
+               stats: Dict = None) -> None:
+    """Program-counter loop shared by whole-program and chunked execution
+
+    The inner loop carries no per-instruction exception handling: the
+    try block is only re-entered after a fault, so error-free spans run
+    exception-setup-free. Profiling, checkpointing, and statistics are
+    checked once here, so the disabled case adds nothing to the
+    dispatch path.
+    """
+    # stash the error collector next to '_calls' so handlers that run
+    # nested programs (PARALLEL workers) report through the same channel
+    expr_globals['_errors'] = errors
+    if PROFILE is not None:
+        return run_instrs_profiled(program, slots, output, expr_globals, errors, PROFILE,
+                                   start_pc)
+    if checkpoint is not None:
+        return run_instrs_checkpointed(program, slots, output, expr_globals, errors,
+                                       checkpoint, start_pc)
+    if stats is not None:
+        return run_instrs_counted(program, slots, output, expr_globals, errors,
+                                  stats, start_pc)
+    handlers = HANDLERS
+    trace = TRACE
+    pc = start_pc
+    n = len(program)
+    while pc < n:
+        try:
+            while pc < n:
+                instr = program[pc]
+                if trace is not None:
+                    trace.emit(instr)
+                target = handlers[instr.op](instr, slots, output, expr_globals)
+                pc = target if target is not None else pc + 1
+        except Exception as e:
+            instr = program[pc]
+            message = e.message if isinstance(e, ClaroError) else str(e)
+            if errors is not None:
+                errors.append({'line': instr.line_number, 'stmt': instr.op.value,
+                               'error': message})
+            else:
+                print(f"Error at line {instr.line_number}: {message}")
+            if instr.op in BRANCH_OPS and instr.target is not None:
+                pc = instr.target
+            else:
+                pc += 1
+
+def run_instrs_profiled(program: List[Instr], slots: List, output: OutputSink,
+                        expr_globals: Dict, errors: List[Dict], profiler: Profiler,
+                        start_pc: int = 0) -> None:
+    """Variant of run_instrs that times every instruction into the profiler"""
+    from time import perf_counter
+    handlers = HANDLERS
+    trace = TRACE
+    pc = start_pc
+    n = len(program)
+    while pc < n:
+        try:
+            while pc < n:
+                instr = program[pc]
+                if trace is not None:
+                    trace.emit(instr)
+                start = perf_counter()
+                target = handlers[instr.op](instr, slots, output, expr_globals)
+                profiler.record(instr, perf_counter() - start)
+                pc = target if target is not None else pc + 1
+        except Exception as e:
+            instr = program[pc]
+            message = e.message if isinstance(e, ClaroError) else str(e)
+            if errors is not None:
+                errors.append({'line': instr.line_number, 'stmt': instr.op.value,
+                               'error': message})
+            else:
+                print(f"Error at line {instr.line_number}: {message}")
+            if instr.op in BRANCH_OPS and instr.target is not None:
+                pc = instr.target
+            else:
+                pc += 1
+
+def unfuse_program(program: List[Instr]) -> List[Instr]:
+    """Undo the peephole pass, restoring one dispatch per source statement
+
+    The fused components are still in place, so swapping each
+    superinstruction back for its original first instruction yields a
+    fully resolved program with per-statement granularity.
+    """
+    return [instr.fused_from or instr for instr in program]
+
+def run_instrs_checkpointed(program: List[Instr], slots: List, output: OutputSink,
+                            expr_globals: Dict, errors: List[Dict],
+                            checkpoint: Checkpointer, start_pc: int = 0) -> None:
+    """Variant of run_instrs that offers the checkpointer a snapshot point per instruction"""
+    handlers = HANDLERS
+    trace = TRACE
+    pc = start_pc
+    n = len(program)
+    while pc < n:
+        try:
+            while pc < n:
+                checkpoint.tick(pc, slots, output, expr_globals)
+                instr = program[pc]
+                if trace is not None:
+                    trace.emit(instr)
+                target = handlers[instr.op](instr, slots, output, expr_globals)
+                pc = target if target is not None else pc + 1
+        except Exception as e:
+            instr = program[pc]
+            message = e.message if isinstance(e, ClaroError) else str(e)
+            if errors is not None:
+                errors.append({'line': instr.line_number, 'stmt': instr.op.value,
+                               'error': message})
+            else:
+                print(f"Error at line {instr.line_number}: {message}")
+            if instr.op in BRANCH_OPS and instr.target is not None:
+                pc = instr.target
+            else:
+                pc += 1
+
+def run_instrs_counted(program: List[Instr], slots: List, output: OutputSink,
+                       expr_globals: Dict, errors: List[Dict], stats: Dict,
+                       start_pc: int = 0) -> None:
+    """Variant of run_instrs that counts executed statements per statement type
+
+    Report mode runs the unfused program, so 'statements' and the
+    per-type counts mean executed source statements (a 100k-iteration
+    WHILE loop counts its condition and body every iteration).
+    """
+    handlers = HANDLERS
+    trace = TRACE
+    counts = stats['by_stmt']
+    pc = start_pc
+    n = len(program)
+    while pc < n:
+        try:
+            while pc < n:
+                instr = program[pc]
+                op = instr.op.value
+                counts[op] = counts.get(op, 0) + 1
+                if trace is not None:
+                    trace.emit(instr)
+                target = handlers[instr.op](instr, slots, output, expr_globals)
+                pc = target if target is not None else pc + 1
+        except Exception as e:
+            instr = program[pc]
+            message = e.message if isinstance(e, ClaroError) else str(e)
+            if errors is not None:
+                errors.append({'line': instr.line_number, 'stmt': instr.op.value,
+                               'error': message})
+            else:
+                print(f"Error at line {instr.line_number}: {message}")
+            if instr.op in BRANCH_OPS and instr.target is not None:
+                pc = instr.target
+            else:
+                pc += 1
+
+# Execution backends selectable at runtime. 'loop' is the reference
+# pure-Python program-counter loop; 'compiled' lowers the whole program
+# into one native code object so the hot path is CPython's own eval
+# loop instead of per-statement dispatch, and falls back to 'loop' for
+# programs the transpiler cannot express.
+BACKENDS = {
+    'loop': run_program,
+    'compiled': run_program_jit,
+}
+
+def get_backend(name: str):
+    """Look up an execution backend by name"""
+    backend = BACKENDS.get(name)
+    if backend is None:
+        raise ClaroError(f"Unknown backend '{name}' (choose from {', '.join(sorted(BACKENDS))})", 0)
+    return backend
+
+def report_validation_errors(error: ProgramValidationError) -> None:
+    """Print every error collected by the validation pass"""
+    for e in error.errors:
+        print(f"Error at line {e.line_number}: {e.message}")
+
+def execute_file(file_path: str, backend: str = 'loop', out_path: str = None,
+                 flush_size: int = 65536, error_report: bool = False,
+                 checkpoint_path: str = None, checkpoint_every: float = 2.0,
+                 resume: bool = False, report: bool = False) -> None:
+    try:
+        runner = get_backend(backend)
+    except ClaroError as e:
+        print(f"Error: {e.message}")
+        sys.exit(1)
+    try:
+        program, symbols = load_or_compile_file(file_path)
+    except ProgramValidationError as e:
+        report_validation_errors(e)
+        sys.exit(1)
+    resume_state = None
+    if resume and checkpoint_path is not None and os.path.exists(checkpoint_path):
+        resume_state = load_checkpoint(checkpoint_path)
+    if out_path is not None:
+        if resume_state is not None and os.path.exists(out_path):
+            # rewind the output file to the snapshot's position so the
+            # resumed run picks up exactly where the checkpoint left off
+            stream = open(out_path, 'r+')
+            stream.seek(resume_state['output_pos'])
+            stream.truncate()
+        else:
+            stream = open(out_path, 'w')
+        sink = BufferedStreamSink(stream, flush_size, close_stream=True)
+    else:
+        sink = ListSink()
+    checkpoint = None
+    if checkpoint_path is not None:
+        if runner is not run_program:
+            # one native code object has no per-statement snapshot
+            # points; a resumable run beats a faster unresumable one
+            sys.stderr.write("Warning: --checkpoint forces the loop backend\n")
+            runner = run_program
+        checkpoint = Checkpointer(checkpoint_path, symbols, checkpoint_every)
+        # tick() only runs between dispatches, and a fused WHILE_VAR
+        # executes its whole loop in one — exactly the long-running
+        # job checkpointing exists for — so checkpointed runs trade
+        # fusion for per-statement snapshot points
+        program = unfuse_program(program)
+    errors = [] if error_report else None
+    stats = {'by_stmt': {}} if report and runner is run_program else None
+    if stats is not None and checkpoint is None:
+        # count real source statements, not fused dispatches: one
+        # WHILE_VAR would otherwise report a 100k-iteration loop as a
+        # single statement
+        program = unfuse_program(program)
+    if PROFILE is not None and runner is run_program and checkpoint is None \
+            and stats is None:
+        # profile real source lines for the same reason: a fused loop
+        # bills everything to the WHILE line and hides the body lines
+        program = unfuse_program(program)
+    from time import perf_counter
+    start = perf_counter()
+    try:
+        if runner is run_program:
+            variables, sink = run_program(program, symbols, sink, errors,
+                                          checkpoint, resume_state, stats)
+        else:
+            variables, sink = runner(program, symbols, sink, errors)
+        wall = perf_counter() - start
+        if isinstance(sink, ListSink):
+            output_bytes = sum(len(item) for item in sink.items)
+        else:
+            output_bytes = sink.position()
+    finally:
+        sink.close()
+    if checkpoint is not None and os.path.exists(checkpoint_path):
+        # the run completed; a stale checkpoint would resume past the end
+        os.remove(checkpoint_path)
+    if error_report:
+        sys.stderr.write(json.dumps({'script': file_path, 'errors': errors}) + '\n')
+    if report:
+        record = {'script': file_path, 'wall_s': wall, 'output_bytes': output_bytes,
+                  'peak_slots': len(variables)}
+        # statement fields only appear when the counting loop ran; the
+        # checkpointed and compiled paths don't collect them
+        if stats is not None and stats['by_stmt']:
+            executed = sum(stats['by_stmt'].values())
+            record['statements'] = executed
+            record['stmts_per_s'] = executed / wall if wall else 0.0
+            record['by_stmt'] = stats['by_stmt']
+        sys.stderr.write(json.dumps(record) + '\n')
+    if isinstance(sink, ListSink) and sink.items:
+        print(''.join(sink.items))
+
+def execute_file_streaming(file_path: str, out_path: str = None, flush_size: int = 65536,
+                           chunk_lines: int = 10000, error_report: bool = False) -> None:
+    """Execute a huge file in bounded chunks, keeping memory constant in file size
+
+    Lines are buffered only until the current chunk is full and all
+    control-flow blocks in it are closed, then compiled and run against
+    the shared slot store, so straight-line regions stream through
+    without ever materializing the whole program.
+    """
+    symbols = SymbolTable()
+    slots: List = []
+    expr_globals = make_expr_globals(slots)
+    if out_path is not None:
+        sink = BufferedStreamSink(open(out_path, 'w'), flush_size, close_stream=True)
+    else:
+        sink = BufferedStreamSink(sys.stdout, flush_size)
+    errors = [] if error_report else None
+    buffer: List[str] = []
+    consumed = 0
+    depth = 0
+
+    def flush_chunk():
+        nonlocal consumed
+        if not buffer:
+            return
+        program, _ = compile_program(buffer, symbols, consumed + 1)
+        consumed += len(buffer)
+        buffer.clear()
+        while len(slots) < len(symbols):
+            slots.append(UNSET)
+        run_instrs(program, slots, sink, expr_globals, errors)
+
+    try:
+        with open(file_path, 'r') as file:
+            for raw in file:
+                line = raw.strip()
+                if not line:
+                    continue
+                word = line.split(None, 1)[0].upper()
+                if word in ('IF', 'WHILE', 'SUB', 'PARALLEL'):
+                    depth += 1
+                elif word == 'END':
+                    depth -= 1
+                buffer.append(line)
+                if depth == 0 and len(buffer) >= chunk_lines:
+                    flush_chunk()
+            flush_chunk()
+    except ProgramValidationError as e:
+        report_validation_errors(e)
+        sys.exit(1)
+    finally:
+        sink.close()
+    if error_report:
+        sys.stderr.write(json.dumps({'script': file_path, 'errors': errors}) + '\n')
+
+def save_session(path: str, symbols: SymbolTable, slots: List) -> None:
+    """Write the interactive variable store to disk for a later reconnect"""
+    import pickle
+    with open(path, 'wb') as file:
+        pickle.dump({'names': symbols.names,
+                     'values': [None if v is UNSET else v for v in slots],
+                     'unset': [v is UNSET for v in slots]},
+                    file, protocol=pickle.HIGHEST_PROTOCOL)
+
+def load_session(path: str, symbols: SymbolTable, slots: List) -> None:
+    """Merge a saved variable store into the current session, matching by name"""
+    import pickle
+    with open(path, 'rb') as file:
+        data = pickle.load(file)
+    for name, value, unset in zip(data['names'], data['values'], data['unset']):
+        idx = symbols.slot(name)
+        while len(slots) <= idx:
+            slots.append(UNSET)
+        if not unset:
+            slots[idx] = value
+
+def interactive_mode() -> None:
+    print("Entering interactive mode (type 'exit' to quit, "
+          "'save <file>'/'load <file>' to keep your variables)")
+    symbols = SymbolTable()
+    slots = []
+    output = ListSink()
+    expr_globals = make_expr_globals(slots)
+    # repeated lines skip the compile pipeline entirely; the key includes
+    # the symbol count so a line compiled before a name existed is redone
+    compiled: Dict[Tuple[str, int], Instr] = {}
+    while True:
+        try:
+            line = input("> ")
+            words = line.split()
+            if not words:
+                continue
+            command = words[0].lower()
+            if command == 'exit':
+                break
+            if command in ('save', 'load') and len(words) == 2:
+                (save_session if command == 'save' else load_session)(
+                    words[1], symbols, slots)
+                print(f"Session {'saved to' if command == 'save' else 'loaded from'} {words[1]}")
+                continue
+            key = (line, len(symbols))
+            instr = compiled.get(key)
+            if instr is None:
+                instr = compile_line(line, 0, symbols)
+                compiled[key] = instr
+            while len(slots) < len(symbols):
+                slots.append(UNSET)
+            if TRACE is not None:
+                TRACE.emit(instr)
+            execute_instr(instr, slots, output, expr_globals)
+            # deliver what this line produced, then drop it: a
+            # long-lived session must not retain every string it ever
+            # printed
+            for item in output.items:
+                print(item)
+            output.items.clear()
+        except ClaroError as e:
+            print(f"Error: {e.message}")
+        except Exception as e:
+            print(f"Error: {e}")
+
+def run_batch_script(path: str) -> Dict:
+    """Execute one script in a worker process, returning its result record
+
+    Scripts repeated in the manifest share one compiled Program per
+    worker; each run only allocates its own ExecutionContext.
+    """
+    try:
+        program = shared_program(path)
+    except ProgramValidationError as e:
+        return {'script': path, 'ok': False, 'output': '',
+                'errors': [{'line': err.line_number, 'error': err.message}
+                           for err in e.errors]}
+    except Exception as e:
+        return {'script': path, 'ok': False, 'output': '', 'errors': [{'error': str(e)}]}
+    context = ExecutionContext(program, errors=[])
+    run_context(program, context)
+    return {'script': path, 'ok': not context.errors,
+            'output': ''.join(context.sink.items), 'errors': context.errors}
+
+def batch_mode(manifest_path: str, jobs: int = None) -> None:
+    """Fan the scripts listed in a manifest out across a pool of warm workers"""
+    from multiprocessing import Pool
+    with open(manifest_path, 'r') as file:
+        paths = [line.strip() for line in file
+                 if line.strip() and not line.strip().startswith('#')]
+    if jobs is None:
+        jobs = os.cpu_count() or 1
+    with Pool(jobs) as pool:
+        results = pool.map(run_batch_script, paths)
+    for result in results:
+        print(json.dumps(result))
+    succeeded = sum(1 for result in results if result['ok'])
+    print(f"{succeeded}/{len(results)} scripts succeeded across {jobs} workers",
+          file=sys.stderr)
+    if succeeded < len(results):
+        sys.exit(1)
+
+def daemon_mode(socket_path: str) -> None:
+    """Serve script-execution requests over a Unix socket with a warm interpreter
+
+    Each connection is handled on its own thread; concurrent requests
+    for the same script share one cached Program and differ only in
+    their per-execution context.
+    """
+    import socket
+    import threading
+    if os.path.exists(socket_path):
+        os.remove(socket_path)
+    server = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+    server.bind(socket_path)
+    server.listen()
+    server.settimeout(0.5)
+    print(f"Claro daemon listening on {socket_path}")
+    stop = threading.Event()
+
+    def serve(conn):
+        with conn:
+            data = b''
+            while True:
+                chunk = conn.recv(65536)
+                if not chunk:
+                    break
+                data += chunk
+            reply, shutdown = handle_daemon_request(data)
+            conn.sendall(json.dumps(reply).encode())
+        if shutdown:
+            stop.set()
+
+    try:
+        while not stop.is_set():
+            try:
+                conn, _ = server.accept()
+            except socket.timeout:
+                continue
+            threading.Thread(target=serve, args=(conn,), daemon=True).start()
+    finally:
+        server.close()
+        if os.path.exists(socket_path):
+            os.remove(socket_path)
+
+def handle_daemon_request(data: bytes) -> Tuple[Dict, bool]:
+    """Run one daemon request: a script path, a script body, or a shutdown order"""
+    try:
+        request = json.loads(data.decode())
+        if request.get('shutdown'):
+            return {'ok': True}, True
+        if 'path' in request:
+            program = shared_program(request['path'])
+        else:
+            instrs, symbols = compile_program(parse_code(request.get('code', '')))
+            program = Program(instrs, symbols)
+        context = ExecutionContext(program)
+        run_context(program, context)
+        return {'output': ''.join(context.sink.items)}, False
+    except ProgramValidationError as e:
+        return {'error': str(e),
+                'errors': [{'line': err.line_number, 'message': err.message}
+                           for err in e.errors]}, False
+    except Exception as e:
+        return {'error': str(e)}, False
+
+def print_help() -> None:
+    import textwrap
+    print(textwrap.dedent("""
+        Usage: claro.py [options]
+        
+        Options:
+            -e <file>      Execute the code from the specified file
+            --backend <name>         Execution backend: 'loop' (reference
+                           interpreter) or 'compiled' (lower the program to
+                           one native code object; --jit is a shorthand)
+            --out <file>   Stream PRINT output to a file instead of memory
+            --flush-size <n>         Flush the output buffer every n characters
+            --stream       Read, compile, and execute the file in bounded chunks
+            --chunk-lines <n>        Lines per chunk in --stream mode
+            --error-report Collect runtime errors into a JSON report on stderr
+                           instead of printing them as they happen
+            --input <file> Feed INPUT statements from a file with read-ahead
+                           buffering (INPUT A B C fills several from one line)
+            --checkpoint <file>      Snapshot interpreter state periodically so a
+                           killed run can continue (--resume to continue,
+                           --checkpoint-every <s> to tune the interval)
+            --report       Emit a JSON run summary on stderr (wall time,
+                           executed source statements and statements/s,
+                           per-statement counts, store size, output bytes)
+            --profile      Print a per-line/per-statement hot-spot report on stderr
+            --profile-folded <file>  Also write flamegraph-style folded stacks
+            -c <file>      Compile the file to a .clarob program for fast startup
+            -d <socket>    Run as a daemon serving scripts over a Unix socket
+            -b <manifest>  Run every script listed in the manifest in parallel
+                           (--jobs <n> to override the worker count)
+            -i             Enter interactive mode
+            --trace        Trace executed lines to stderr (off by default)
+            --trace-sample <n>       Emit every nth traced line
+            --trace-filter <types>   Only trace these statement types (comma-separated)
+            --trace-json   Emit traces as JSON lines for log shipping
+            -h, --help     Show this help message
+            --version      Show version information
+    """))
+
+def print_version() -> None:
+    print("Claro Interpreter Version 1.0")
+
+def main() -> None:
+    if len(sys.argv) == 1:
+        print_help()
+        sys.exit(0)
+
+    if len(sys.argv) < 2:
+        print("Error: Missing command-line arguments")
+        print_help()
+        sys.exit(1)
+
+    if sys.argv[1] == '-e':
+        args = parse_trace_options(sys.argv[2:])
+        backend = 'loop'
+        if '--jit' in args:
+            # kept as a shorthand for the compiled backend
+            backend = 'compiled'
+            args = [arg for arg in args if arg != '--jit']
+        if '--backend' in args:
+            i = args.index('--backend')
+            backend = args[i + 1]
+            del args[i:i + 2]
+        out_path = None
+        flush_size = 65536
+        if '--out' in args:
+            i = args.index('--out')
+            out_path = args[i + 1]
+            del args[i:i + 2]
+        if '--flush-size' in args:
+            i = args.index('--flush-size')
+            flush_size = int(args[i + 1])
+            del args[i:i + 2]
+        error_report = '--error-report' in args
+        args = [arg for arg in args if arg != '--error-report']
+        stream = '--stream' in args
+        args = [arg for arg in args if arg != '--stream']
+        global INPUT_SOURCE
+        if '--input' in args:
+            i = args.index('--input')
+            INPUT_SOURCE = InputSource(open(args[i + 1], 'r'))
+            del args[i:i + 2]
+        global PROFILE
+        folded_path = None
+        if '--profile-folded' in args:
+            i = args.index('--profile-folded')
+            folded_path = args[i + 1]
+            del args[i:i + 2]
+        if '--profile' in args or folded_path is not None:
+            args = [arg for arg in args if arg != '--profile']
+            PROFILE = Profiler()
+        chunk_lines = 10000
+        if '--chunk-lines' in args:
+            i = args.index('--chunk-lines')
+            chunk_lines = int(args[i + 1])
+            del args[i:i + 2]
+        checkpoint_path = None
+        checkpoint_every = 2.0
+        if '--checkpoint' in args:
+            i = args.index('--checkpoint')
+            checkpoint_path = args[i + 1]
+            del args[i:i + 2]
+        if '--checkpoint-every' in args:
+            i = args.index('--checkpoint-every')
+            checkpoint_every = float(args[i + 1])
+            del args[i:i + 2]
+        resume = '--resume' in args
+        args = [arg for arg in args if arg != '--resume']
+        report = '--report' in args
+        args = [arg for arg in args if arg != '--report']
+        if len(args) != 1:
+            print_help()
+            sys.exit(1)
+        if stream:
+            execute_file_streaming(args[0], out_path=out_path, flush_size=flush_size,
+                                   chunk_lines=chunk_lines, error_report=error_report)
+        else:
+            execute_file(args[0], backend=backend, out_path=out_path, flush_size=flush_size,
+                         error_report=error_report, checkpoint_path=checkpoint_path,
+                         checkpoint_every=checkpoint_every, resume=resume, report=report)
+        if PROFILE is not None:
+            PROFILE.report(sys.stderr)
+            if folded_path is not None:
+                with open(folded_path, 'w') as file:
+                    PROFILE.write_folded(file)
+    elif sys.argv[1] == '-c':
+        if len(sys.argv) != 3:
+            print_help()
+            sys.exit(1)
+        compile_file(sys.argv[2])
+    elif sys.argv[1] == '-b':
+        args = sys.argv[2:]
+        jobs = None
+        if '--jobs' in args:
+            i = args.index('--jobs')
+            jobs = int(args[i + 1])
+            del args[i:i + 2]
+        if len(args) != 1:
+            print_help()
+            sys.exit(1)
+        batch_mode(args[0], jobs=jobs)
+    elif sys.argv[1] == '-d':
+        if len(sys.argv) != 3:
+            print_help()
+            sys.exit(1)
+        daemon_mode(sys.argv[2])
+    elif sys.argv[1] == '-i':
+        parse_trace_options(sys.argv[2:])
+        interactive_mode()
+    elif sys.argv[1] == '-h' or sys.argv[1] == '--help':
+        print_help()
+    elif sys.argv[1] == '--version':
+        print_version()
+    else:
+        print("Error: Invalid option")
+        print_help()
+        sys.exit(1)
+
+if __name__ == '__main__':
+    main()
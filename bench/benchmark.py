@@ -0,0 +1,129 @@
+"""Benchmark harness for the Claro interpreter.
+
+Runs representative workloads against the in-tree Claro.py and reports
+per-workload timing and statements/second, so changes to the compile
+pipeline and execute loop can be quantified instead of guessed at.
+
+Usage:
+    python bench/benchmark.py                     Run all workloads
+    python bench/benchmark.py --jit               Run through the transpiler backend
+    python bench/benchmark.py --repeat <n>        Best-of-n timing (default 3)
+    python bench/benchmark.py --save-baseline <file>
+    python bench/benchmark.py --compare <file>    Show deltas against a saved baseline
+"""
+import json
+import os
+import sys
+import time
+
+sys.path.insert(0, os.path.dirname(os.path.dirname(os.path.abspath(__file__))))
+import Claro
+
+
+def while_loop_workload(n=200000):
+    """Tight WHILE loop: n iterations of increment-and-test"""
+    lines = ['VARIABLE I 0', f'WHILE I < {n}', 'VARIABLE I I + 1', 'END']
+    return lines, 2 + 3 * n
+
+
+def print_heavy_workload(n=50000):
+    """PRINT-heavy output: n prints of one variable"""
+    lines = ['VARIABLE MSG hello']
+    lines.extend(['PRINT MSG'] * n)
+    return lines, 1 + n
+
+
+def variable_churn_workload(n=50000):
+    """VARIABLE churn: n writes cycling through 8 slots"""
+    return [f'VARIABLE V{i % 8} {i}' for i in range(n)], n
+
+
+def if_dense_workload(n=20000):
+    """IF-dense branching: n IF/ELSE blocks, true branch taken"""
+    lines = ['VARIABLE X 5']
+    for _ in range(n):
+        lines.extend(['IF X > 3', 'PRINT yes', 'ELSE', 'PRINT no', 'END'])
+    return lines, 1 + 3 * n
+
+
+def parse_only_workload(n=100000):
+    """Parse/compile only: a large straight-line file, never executed"""
+    return [f'VARIABLE V{i % 16} {i}' for i in range(n)], n
+
+
+WORKLOADS = [
+    ('while_loop', while_loop_workload, 'execute'),
+    ('print_heavy', print_heavy_workload, 'execute'),
+    ('variable_churn', variable_churn_workload, 'execute'),
+    ('if_dense', if_dense_workload, 'execute'),
+    ('parse_only', parse_only_workload, 'compile'),
+]
+
+
+def run_workload(generator, mode, jit=False, repeat=3):
+    """Time one workload, returning its best-of-n result record"""
+    lines, executed = generator()
+    compile_s = min(_timed(lambda: Claro.compile_program(lines)) for _ in range(repeat))
+    result = {'compile_s': compile_s, 'statements': executed}
+    if mode == 'execute':
+        program, symbols = Claro.compile_program(lines)
+        runner = Claro.run_program_jit if jit else Claro.run_program
+        exec_s = min(
+            _timed(lambda: runner(program, symbols, Claro.ListSink()))
+            for _ in range(repeat))
+        result['exec_s'] = exec_s
+        result['stmts_per_s'] = executed / exec_s if exec_s else 0.0
+    return result
+
+
+def _timed(fn):
+    start = time.perf_counter()
+    fn()
+    return time.perf_counter() - start
+
+
+def main():
+    args = sys.argv[1:]
+    jit = '--jit' in args
+    args = [a for a in args if a != '--jit']
+    repeat = 3
+    if '--repeat' in args:
+        i = args.index('--repeat')
+        repeat = int(args[i + 1])
+        del args[i:i + 2]
+    save_path = compare_path = None
+    if '--save-baseline' in args:
+        i = args.index('--save-baseline')
+        save_path = args[i + 1]
+        del args[i:i + 2]
+    if '--compare' in args:
+        i = args.index('--compare')
+        compare_path = args[i + 1]
+        del args[i:i + 2]
+
+    baseline = {}
+    if compare_path:
+        with open(compare_path, 'r') as file:
+            baseline = json.load(file)
+
+    results = {}
+    for name, generator, mode in WORKLOADS:
+        result = run_workload(generator, mode, jit=jit, repeat=repeat)
+        results[name] = result
+        line = f"{name:20} compile {result['compile_s'] * 1000:9.2f} ms"
+        if 'exec_s' in result:
+            line += (f"   exec {result['exec_s'] * 1000:9.2f} ms"
+                     f"   {result['stmts_per_s']:12,.0f} stmts/s")
+        if name in baseline and 'exec_s' in result and 'exec_s' in baseline[name]:
+            delta = (result['exec_s'] / baseline[name]['exec_s'] - 1.0) * 100
+            line += f"   {delta:+6.1f}% vs baseline"
+        print(line)
+
+    if save_path:
+        with open(save_path, 'w') as file:
+            json.dump(results, file, indent=2)
+        print(f"Baseline saved to {save_path}")
+
+
+if __name__ == '__main__':
+    main()